@@ -9,19 +9,42 @@
 #include <list>
 #include <vector>
 #include <stack>
+#include <type_traits>
+
+//Сравнение ключей: -1, 0 или 1 за один проход вместо двух сравнений на уровень
+template <typename KeyType, bool Arithmetic = std::is_arithmetic<KeyType>::value>
+struct RBTreeKeyTraits {
+    typedef const KeyType& param_type;
+    static int compare(const KeyType& a, const KeyType& b){
+        return a < b ? -1 : (a > b ? 1 : 0);
+    }
+};
+
+//Для арифметических ключей (int, uint64_t, double) - передача по значению
+//и сравнение без ветвлений
+template <typename KeyType>
+struct RBTreeKeyTraits<KeyType, true> {
+    typedef KeyType param_type;
+    static int compare(KeyType a, KeyType b){
+        return static_cast<int>(a > b) - static_cast<int>(a < b);
+    }
+};
+
 template <typename ValueType, typename KeyType>
 class RBTree {
     enum color{
         red,
         black
     };
+    typedef RBTreeKeyTraits<KeyType> key_traits;
+    typedef typename key_traits::param_type key_param;
     class Node{
         public:
             Node(const KeyType& key, const ValueType& value,
                     Node* parent = nullptr, Node* child_left = nullptr,
                     Node* child_right = nullptr);
             ~Node() = default;
-            KeyType getKey();
+            key_param getKey();
             RBTree::color getColor();
             Node* getRightChild();
             Node* getLeftChild();
@@ -49,6 +72,28 @@ class RBTree {
             RBTree::color nodeColor = RBTree::color::red;//по умолчанию изначально вставляется красный потомок
         };
 public:
+    //Ленивый обход диапазона [lo, hi]: O(log n) до первого элемента, O(1) памяти
+    class Cursor{
+        public:
+            bool isEnd() const;
+            key_param getKey() const;
+            const ValueType& getValue() const;
+            void next();
+            //Повторный поиск позиции после изменения дерева: курсор встаёт
+            //на тот же элемент или на следующий, если тот был удалён
+            void resume();
+            friend class RBTree;
+
+        private:
+            Cursor(const RBTree* tree, const KeyType& lo, const KeyType& hi);
+            void land(Node* node);
+
+            const RBTree* _tree;
+            Node* _node;
+            KeyType _hi;
+            KeyType _last;//ключ текущего элемента
+            size_t _dups;//номер текущего элемента среди равных _last
+        };
     RBTree();
     RBTree(const RBTree& copy);
     RBTree& operator=(const RBTree& copy);
@@ -61,6 +106,7 @@ public:
     ValueType find(const KeyType& key)const;
     size_t getCapacity()const;
     bool isEmpty()const;
+    Cursor scan(const KeyType& lo, const KeyType& hi)const;
 protected:
 
     Node * deleteNode(Node* node);
@@ -75,7 +121,10 @@ protected:
     void fourthAddCase(Node* node);
     void fifthAddCase(Node* node);
 
-    Node* find(const KeyType& key, Node* root);
+    Node* find(key_param key, Node* root) const;
+
+    Node* lowerBound(key_param key) const;//Первый узел с ключом не меньше key
+    Node* getNext(Node* node) const;//Следующий узел при симметричном обходе
 
     Node* getLastRight(Node* root);//Получить узел с наибольшим ключом
     Node* getLastLeft(Node* root);//Получить узел с наименьшим узлом
@@ -212,24 +261,60 @@ void RBTree<ValueType, KeyType>::rightRotate(RBTree::Node *node) {
 template<typename ValueType, typename KeyType>
 ValueType RBTree<ValueType, KeyType>::find(const KeyType &key) const{
     Node* result_node = find(key, _root);
-    return result_node? result_node->getValue(): NULL;
+    return result_node? result_node->getValue(): ValueType();
 }
 
 template<typename ValueType, typename KeyType>
-typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::find(const KeyType &key, RBTree::Node *root) {
+typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::find(key_param key, RBTree::Node *root) const{
     Node* node = root;
     while(node){
-        if(key < node->getKey()){
-            node = node->getLeftChild();
+        const int cmp = key_traits::compare(key, node->key);
+        if(!cmp){
+            return node;
         }
-        else if(key > node->getKey()){
-            node = node->getRightChild();
+        //выбор потомка без второго сравнения ключей
+        node = cmp < 0? node->child_left: node->child_right;
+    }
+    return nullptr;
+}
+
+template<typename ValueType, typename KeyType>
+typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::lowerBound(key_param key) const {
+    Node* node = _root;
+    Node* result = nullptr;
+    while(node){
+        if(key_traits::compare(node->key, key) < 0){
+            node = node->child_right;
         }
         else{
-            return node;
+            result = node;
+            node = node->child_left;
         }
     }
-    return nullptr;
+    return result;
+}
+
+template<typename ValueType, typename KeyType>
+typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::getNext(Node* node) const {
+    if(node->child_right){
+        node = node->child_right;
+        while(node->child_left){
+            node = node->child_left;
+        }
+        return node;
+    }
+    //поднимаемся, пока приходим из правого поддерева
+    Node* p = node->parent;
+    while(p && node == p->child_right){
+        node = p;
+        p = p->parent;
+    }
+    return p;
+}
+
+template<typename ValueType, typename KeyType>
+typename RBTree<ValueType, KeyType>::Cursor RBTree<ValueType, KeyType>::scan(const KeyType &lo, const KeyType &hi) const {
+    return Cursor(this, lo, hi);
 }
 
 template<typename ValueType, typename KeyType>
@@ -326,7 +411,7 @@ void RBTree<ValueType, KeyType>::afterDelFix(RBTree::Node *node) {
                 node = node->getParent();
             }
             else{
-                if (s->getLeftChild()->getColor() == color::black) {
+                if (!s->getLeftChild() || s->getLeftChild()->getColor() == color::black) {
                     s->getRightChild()->setColor(color::black);
                     s->setColor(color::red);
                     leftRotate(s);
@@ -566,7 +651,7 @@ RBTree<ValueType, KeyType>::Node::Node(const KeyType &key,
 }
 
 template<typename ValueType, typename KeyType>
-KeyType RBTree<ValueType, KeyType>::Node::getKey() {
+typename RBTree<ValueType, KeyType>::key_param RBTree<ValueType, KeyType>::Node::getKey() {
     return this->key;
 }
 
@@ -617,25 +702,15 @@ typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::Node::get
 template<typename ValueType, typename KeyType>
 typename RBTree<ValueType, KeyType>::Node *RBTree<ValueType, KeyType>::Node::insert(const KeyType &key, const ValueType &value) {
     Node* current_node = this;
-    if(current_node->key > key){
-        if(!current_node->child_left){
-            current_node->child_left =
-                    new Node(key, value, current_node);
-            return current_node->child_left;
-        }
-        else{
-            return current_node->child_left->insert(key, value);
-        }
-    }
-    else{
-        if(!current_node->child_right){
-            current_node->child_right =
-                    new Node(key, value, current_node);
-            return current_node->child_right;
-        }
-        else{
-            return current_node->child_right->insert(key, value);
+    //спуск без рекурсии, равные ключи уходят вправо
+    while(true){
+        Node*& child = RBTree::key_traits::compare(key, current_node->key) < 0?
+                current_node->child_left: current_node->child_right;
+        if(!child){
+            child = new Node(key, value, current_node);
+            return child;
         }
+        current_node = child;
     }
 }
 
@@ -674,4 +749,70 @@ void RBTree<ValueType, KeyType>::Node::setKey(const KeyType &new_key) {
     key = new_key;
 }
 
+template<typename ValueType, typename KeyType>
+RBTree<ValueType, KeyType>::Cursor::Cursor(const RBTree *tree, const KeyType &lo, const KeyType &hi):
+        _tree(tree), _node(nullptr), _hi(hi), _last(lo), _dups(0) {
+    land(_tree->lowerBound(lo));
+}
+
+template<typename ValueType, typename KeyType>
+void RBTree<ValueType, KeyType>::Cursor::land(Node *node) {
+    if(node && key_traits::compare(node->key, _hi) > 0){
+        node = nullptr;
+    }
+    _node = node;
+    if(!_node){
+        return;
+    }
+    if(_dups && !key_traits::compare(_node->key, _last)){
+        _dups += 1;
+    }
+    else{
+        _last = _node->key;
+        _dups = 1;
+    }
+}
+
+template<typename ValueType, typename KeyType>
+bool RBTree<ValueType, KeyType>::Cursor::isEnd() const {
+    return _node == nullptr;
+}
+
+template<typename ValueType, typename KeyType>
+typename RBTree<ValueType, KeyType>::key_param RBTree<ValueType, KeyType>::Cursor::getKey() const {
+    return _node->getKey();
+}
+
+template<typename ValueType, typename KeyType>
+const ValueType &RBTree<ValueType, KeyType>::Cursor::getValue() const {
+    return _node->getValue();
+}
+
+template<typename ValueType, typename KeyType>
+void RBTree<ValueType, KeyType>::Cursor::next() {
+    if(_node){
+        land(_tree->getNext(_node));
+    }
+}
+
+template<typename ValueType, typename KeyType>
+void RBTree<ValueType, KeyType>::Cursor::resume() {
+    if(!_node){
+        return;
+    }
+    //при удалении узлы обмениваются ключами, поэтому указателю не доверяем
+    const size_t skip = _dups - 1;
+    const KeyType last = _last;//land() перезапишет _last
+    Node* node = _tree->lowerBound(last);
+    for(size_t i = 0; i < skip && node && !key_traits::compare(node->key, last); ++i){
+        node = _tree->getNext(node);
+    }
+    _dups = 0;
+    land(node);
+    //счётчик равных сохраняется, только если встали на прежний ключ
+    if(_node && !key_traits::compare(_node->key, last)){
+        _dups = skip + 1;
+    }
+}
+
 #endif //RED_BLACK_TREE_RBTREE_H
@@ -0,0 +1,65 @@
+//
+// Сравнение скорости add/find для арифметических ключей (uint64_t)
+// и ключей, проходящих через обобщённый RBTreeKeyTraits.
+//
+
+#include "../RBTree.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+//Та же величина, но не арифметический тип - используется обобщённое сравнение
+struct WrappedKey{
+    uint64_t v;
+    WrappedKey(uint64_t v = 0): v(v){}
+    bool operator<(const WrappedKey& other) const { return v < other.v; }
+    bool operator>(const WrappedKey& other) const { return v > other.v; }
+};
+
+template<typename KeyType>
+void run(const char* name, const std::vector<uint64_t>& keys, int rounds){
+    typedef std::chrono::steady_clock clock;
+    RBTree<uint64_t, KeyType> tree;
+
+    clock::time_point start = clock::now();
+    for(size_t i = 0; i < keys.size(); ++i){
+        tree.add(KeyType(keys[i]), i);
+    }
+    clock::time_point added = clock::now();
+
+    uint64_t checksum = 0;
+    for(int r = 0; r < rounds; ++r){
+        for(size_t i = 0; i < keys.size(); ++i){
+            checksum += tree.find(KeyType(keys[i]));
+        }
+    }
+    clock::time_point found = clock::now();
+
+    long long add_ms = std::chrono::duration_cast<std::chrono::milliseconds>(added - start).count();
+    long long find_ms = std::chrono::duration_cast<std::chrono::milliseconds>(found - added).count();
+    std::printf("%-10s add: %6lld ms  find: %6lld ms  (checksum %llu)\n",
+                name, add_ms, find_ms, (unsigned long long)checksum);
+}
+
+//Без аргументов прогоняются оба варианта; для честного сравнения лучше
+//запускать каждый в отдельном процессе: key_compare generic / key_compare uint64
+int main(int argc, char** argv){
+    const char* only = argc > 1? argv[1]: nullptr;
+    const size_t count = 1000000;
+    const int rounds = 3;
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(count);
+    for(size_t i = 0; i < count; ++i){
+        keys[i] = rng() % (count * 5);
+    }
+    if(!only || !std::strcmp(only, "generic")){
+        run<WrappedKey>("generic", keys, rounds);
+    }
+    if(!only || !std::strcmp(only, "uint64")){
+        run<uint64_t>("uint64_t", keys, rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+//
+// Проверка RBTree::scan и RBTree::Cursor.
+//
+
+#include "../RBTree.h"
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+typedef RBTree<int, int> Tree;
+
+//Ключи оставшейся части диапазона
+static std::vector<int> drain(Tree::Cursor& c){
+    std::vector<int> keys;
+    for(; !c.isEnd(); c.next()){
+        keys.push_back(c.getKey());
+    }
+    return keys;
+}
+
+static std::vector<int> collect(const Tree& tree, int lo, int hi){
+    Tree::Cursor c = tree.scan(lo, hi);
+    return drain(c);
+}
+
+//5 5 5 7 7 7 9
+static void fill(Tree& tree){
+    const int keys[] = {5, 7, 9, 5, 7, 5, 7};
+    for(int key: keys){
+        tree.add(key, key * 10);
+    }
+}
+
+static void testBounds(){
+    Tree empty;
+    assert(empty.scan(0, 100).isEnd());
+
+    Tree tree;
+    fill(tree);
+    assert(collect(tree, 6, 6).empty());//пустой диапазон между ключами
+    assert(collect(tree, 100, 0).empty());//lo > hi
+    assert(collect(tree, 0, 4).empty());//hi ниже наименьшего ключа
+    assert(collect(tree, 10, 20).empty());//lo выше наибольшего ключа
+    assert(collect(tree, 7, 7) == std::vector<int>({7, 7, 7}));
+    assert(collect(tree, 0, 100) == std::vector<int>({5, 5, 5, 7, 7, 7, 9}));
+
+    Tree::Cursor c = tree.scan(9, 9);
+    assert(!c.isEnd() && c.getValue() == 90);
+}
+
+//resume() без изменений дерева не сдвигает курсор внутри серии равных
+static void testResumeInPlace(){
+    Tree tree;
+    fill(tree);
+    Tree::Cursor c = tree.scan(0, 100);
+    c.next();
+    c.resume();
+    c.resume();
+    assert(drain(c) == std::vector<int>({5, 5, 7, 7, 7, 9}));
+}
+
+static void testResumeAfterRemoveCurrent(){
+    Tree tree;
+    const int keys[] = {3, 5, 7, 9};
+    for(int key: keys){
+        tree.add(key, key);
+    }
+    Tree::Cursor c = tree.scan(0, 100);
+    c.next();
+    assert(c.getKey() == 5);
+    tree.remove(5);
+    c.resume();
+    assert(drain(c) == std::vector<int>({7, 9}));
+}
+
+static void testResumeAfterRemoveBefore(){
+    Tree tree;
+    fill(tree);
+    tree.add(1, 1);
+    tree.add(2, 2);
+    Tree::Cursor c = tree.scan(0, 100);
+    while(c.getKey() != 7){
+        c.next();
+    }
+    c.next();//вторая 7
+    tree.remove_all(1);
+    tree.remove_all(5);
+    c.resume();
+    assert(drain(c) == std::vector<int>({7, 7, 9}));
+}
+
+static void testResumeAfterRemoveAllCopies(){
+    Tree tree;
+    fill(tree);
+    Tree::Cursor c = tree.scan(0, 100);
+    c.next();
+    c.next();//третья 5
+    assert(c.getKey() == 5);
+    tree.remove_all(5);
+    c.resume();
+    c.resume();
+    assert(drain(c) == std::vector<int>({7, 7, 7, 9}));
+}
+
+static void testResumeAfterAdd(){
+    Tree tree;
+    fill(tree);
+    Tree::Cursor c = tree.scan(0, 8);
+    c.next();//вторая 5
+    tree.add(6, 6);
+    tree.add(100, 100);
+    c.resume();
+    assert(drain(c) == std::vector<int>({5, 5, 6, 7, 7, 7}));
+}
+
+int main(){
+    testBounds();
+    testResumeInPlace();
+    testResumeAfterRemoveCurrent();
+    testResumeAfterRemoveBefore();
+    testResumeAfterRemoveAllCopies();
+    testResumeAfterAdd();
+    std::printf("scan_test: OK\n");
+    return 0;
+}